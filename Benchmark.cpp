@@ -0,0 +1,233 @@
+#include "Benchmark.h"
+
+#include "GraphAdjList.h"
+#include "GraphAllocator.h"
+#include "Parallel.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//生成随机图：先连一条链保证连通，其余边随机，不做重边检查
+static void GenerateRandomEdges(int n, int m, std::vector<EdgeInput>& edges) {
+    edges.clear();
+    edges.reserve(static_cast<size_t>(m));
+    std::mt19937 rng(20240601);
+    std::uniform_int_distribution<int> vertexDist(1, n);
+    std::uniform_int_distribution<int> weightDist(1, 1000);
+    for (int v = 1; v < n && static_cast<int>(edges.size()) < m; ++v) {
+        edges.push_back({v, v + 1, weightDist(rng)});
+    }
+    while (static_cast<int>(edges.size()) < m) {
+        int u = vertexDist(rng);
+        int v = vertexDist(rng);
+        if (u != v) {
+            edges.push_back({u, v, weightDist(rng)});
+        }
+    }
+}
+
+static bool SameAdjacency(const GraphAdjList& a, const GraphAdjList& b) {
+    if (a.VertexCount() != b.VertexCount()) {
+        return false;
+    }
+    for (int v = 1; v <= a.VertexCount(); ++v) {
+        auto x = a.Neighbors(v);
+        auto y = b.Neighbors(v);
+        if (x.size() != y.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < x.size(); ++i) {
+            if (x[i].to != y[i].to || x[i].weight != y[i].weight) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void RunBuildBenchmark(int n, int m) {
+    if (n < 2 || m < 1) {
+        std::cout << "参数不合法.\n";
+        return;
+    }
+    std::vector<EdgeInput> edges;
+    GenerateRandomEdges(n, m, edges);
+
+    std::vector<unsigned> threadCounts;
+    unsigned hw = ResolveThreadCount(0);
+    for (unsigned t = 1; t < hw; t *= 2) {
+        threadCounts.push_back(t);
+    }
+    threadCounts.push_back(hw);
+
+    GraphAdjList reference;
+    reference.Build(n, edges, 1);
+
+    const int repeats = 3;
+    double baseSeconds = 0;
+    std::cout << "建图性能测试: n = " << n << ", m = " << m << "\n";
+    if (static_cast<size_t>(m) < GraphAdjList::kParallelBuildThreshold) {
+        std::cout << "边数少于 " << GraphAdjList::kParallelBuildThreshold
+                  << " 时建图总是串行，只测试单线程.\n";
+        threadCounts.assign(1, 1);
+    }
+    for (unsigned t : threadCounts) {
+        double best = 0;
+        unsigned used = 1;
+        GraphAdjList g;
+        for (int r = 0; r < repeats; ++r) {
+            auto begin = std::chrono::steady_clock::now();
+            used = g.Build(n, edges, t);
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - begin).count();
+            best = (r == 0) ? seconds : std::min(best, seconds);
+        }
+        if (t == 1) {
+            baseSeconds = best;
+        }
+        double throughput = best > 0 ? static_cast<double>(m) / best : 0;
+        double speedup = best > 0 ? baseSeconds / best : 0;
+        std::cout << "线程数 " << t << "（实际 " << used << "）: 用时 " << best * 1000 << " ms, "
+                  << throughput << " 边/秒, 加速比 " << speedup
+                  << (SameAdjacency(reference, g) ? "" : " [结果不一致]") << "\n";
+    }
+}
+
+//dTLB 读缺失计数器，无法打开时 Stop 返回 -1
+class TlbMissCounter {
+public:
+    TlbMissCounter() : fd_(-1) {
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~TlbMissCounter() {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+#endif
+    }
+
+    TlbMissCounter(const TlbMissCounter&) = delete;
+    TlbMissCounter& operator=(const TlbMissCounter&) = delete;
+
+    void Start() {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    long long Stop() {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            long long count = 0;
+            if (read(fd_, &count, sizeof(count)) == static_cast<ssize_t>(sizeof(count))) {
+                return count;
+            }
+        }
+#endif
+        return -1;
+    }
+
+private:
+    int fd_;
+};
+
+static void PrintTlbMisses(long long misses) {
+    if (misses < 0) {
+        std::cout << "不可用";
+    } else {
+        std::cout << misses;
+    }
+}
+
+void RunTraversalBenchmark(int n, int m) {
+    if (n < 2 || m < 1) {
+        std::cout << "参数不合法.\n";
+        return;
+    }
+    std::vector<EdgeInput> edges;
+    GenerateRandomEdges(n, m, edges);
+
+    const PagePolicy savedPages = GetGraphPagePolicy();
+    const NumaPolicy numa = GetGraphNumaPolicy();
+    const PagePolicy policies[] = {PagePolicy::Default, PagePolicy::TransparentHuge, PagePolicy::ExplicitHuge};
+
+    std::cout << "遍历性能测试: n = " << n << ", m = " << m
+              << ", NUMA 策略 = " << NumaPolicyName(numa) << "\n";
+    TlbMissCounter counter;
+    for (PagePolicy pages : policies) {
+        SetGraphMemoryPolicy(pages, numa);
+        GraphMemoryStats before = GetGraphMemoryStats();
+        long long hugeBefore = ReadAnonHugePagesBytes();
+        long long hugeDuring = -1;
+        {
+            GraphAdjList g;
+            g.Build(n, edges);
+
+            std::vector<int> order;
+            std::vector<std::pair<int, int>> treeEdges;
+            GraphVector<int> parent;
+            GraphVector<long long> dist;
+
+            counter.Start();
+            auto begin = std::chrono::steady_clock::now();
+            g.BFS(1, order, treeEdges, parent);
+            auto end = std::chrono::steady_clock::now();
+            long long bfsMisses = counter.Stop();
+            double bfsMs = std::chrono::duration<double, std::milli>(end - begin).count();
+
+            counter.Start();
+            begin = std::chrono::steady_clock::now();
+            g.Dijkstra(1, parent, dist);
+            end = std::chrono::steady_clock::now();
+            long long dijkstraMisses = counter.Stop();
+            double dijkstraMs = std::chrono::duration<double, std::milli>(end - begin).count();
+
+            std::cout << PagePolicyName(pages) << ": BFS " << bfsMs << " ms, dTLB 缺失 ";
+            PrintTlbMisses(bfsMisses);
+            std::cout << "; Dijkstra " << dijkstraMs << " ms, dTLB 缺失 ";
+            PrintTlbMisses(dijkstraMisses);
+            std::cout << "\n";
+            // 图与遍历缓冲区仍存活时读取，反映实际得到的透明大页
+            hugeDuring = ReadAnonHugePagesBytes();
+        }
+        GraphMemoryStats after = GetGraphMemoryStats();
+        std::cout << "  显式大页 " << (after.hugetlbBytes - before.hugetlbBytes) << " 字节, 已 madvise "
+                  << (after.thpAdvisedBytes - before.thpAdvisedBytes) << " 字节, 实际透明大页 ";
+        if (hugeBefore < 0 || hugeDuring < 0) {
+            std::cout << "不可用";
+        } else {
+            std::cout << hugeDuring - hugeBefore << " 字节";
+        }
+        std::cout << ", 交错分配 "
+                  << (after.interleaveBytes - before.interleaveBytes) << " 字节, 回退 "
+                  << (after.fallbacks - before.fallbacks) << " 次\n";
+    }
+    SetGraphMemoryPolicy(savedPages, numa);
+}
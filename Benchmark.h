@@ -0,0 +1,12 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+// 随机生成 n 个顶点、m 条边的图，按不同线程数建图并输出吞吐量（边/秒）
+void RunBuildBenchmark(int n, int m);
+
+// 随机生成图，依次用默认页、透明大页、显式大页分配图存储，
+// 比较 BFS 与 Dijkstra 的用时和 dTLB 缺失次数（Linux 下通过 perf_event 读取），
+// 并报告实际得到的大页字节数（透明大页取自 /proc/self/smaps_rollup）
+void RunTraversalBenchmark(int n, int m);
+
+#endif
@@ -4,34 +4,33 @@
 #include <iostream>
 #include <queue>
 
-GraphAML::GraphAML() : n_(0) {}
+GraphAML::GraphAML() : n_(0), edges_(nullptr) {}
 
-GraphAML::~GraphAML() {
-    for (auto* e : edges_) {
-        delete e;
-    }
-}
-
-void GraphAML::Init(int n) {
+void GraphAML::Build(int n, const std::vector<EdgeInput>& edges) {
     n_ = n;
-    vertices_.assign(n_ + 1, {nullptr});
-    for (auto* e : edges_) {
-        delete e;
+    edges_ = &edges;
+    vertices_.assign(n_ + 1, {-1});
+    links_.assign(edges.size(), {-1, -1});
+    for (size_t i = 0; i < edges.size(); ++i) {
+        const EdgeInput& e = edges[i];
+        if (e.u < 1 || e.v < 1 || e.u > n_ || e.v > n_) {
+            continue;
+        }
+        // 邻接多重表边结点，第 i 条边挂到两个端点的链头
+        int id = static_cast<int>(i);
+        links_[i].ilink = vertices_[e.u].firstEdge;
+        links_[i].jlink = vertices_[e.v].firstEdge;
+        vertices_[e.u].firstEdge = id;
+        vertices_[e.v].firstEdge = id;
     }
-    edges_.clear();
 }
 
-void GraphAML::AddEdge(int u, int v, int w) {
-    if (u < 1 || v < 1 || u > n_ || v > n_) {
-        return;
-    }
-    // 邻接多重表边结点，记录两个端点及两条链指针
-    auto* edge = new AMLEdge{u, v, w, nullptr, nullptr};
-    edge->ilink = vertices_[u].firstEdge;
-    edge->jlink = vertices_[v].firstEdge;
-    vertices_[u].firstEdge = edge;
-    vertices_[v].firstEdge = edge;
-    edges_.push_back(edge);
+//释放视图占用的内存，需要时再重新 Build
+void GraphAML::Clear() {
+    n_ = 0;
+    edges_ = nullptr;
+    GraphVector<AMLVNode>().swap(vertices_);
+    GraphVector<AMLEdge>().swap(links_);
 }
 
 bool GraphAML::IsReady() const {
@@ -44,24 +43,25 @@ int GraphAML::VertexCount() const {
 
 std::vector<int> GraphAML::CollectNeighbors(int v) const {
     std::vector<int> neighbors;
-    AMLEdge* cur = vertices_[v].firstEdge;
-    while (cur) {
-        int other = (cur->ivex == v) ? cur->jvex : cur->ivex;
+    int cur = vertices_[v].firstEdge;
+    while (cur != -1) {
+        const EdgeInput& e = (*edges_)[cur];
+        int other = (e.u == v) ? e.v : e.u;
         neighbors.push_back(other);
         // 沿着属于 v 的那条链走
-        cur = (cur->ivex == v) ? cur->ilink : cur->jlink;
+        cur = (e.u == v) ? links_[cur].ilink : links_[cur].jlink;
     }
     std::sort(neighbors.begin(), neighbors.end());
     return neighbors;
 }
 
 void GraphAML::BFS(int start, std::vector<int>& order, std::vector<std::pair<int, int>>& treeEdges,
-                   std::vector<int>& parent) const {
+                   GraphVector<int>& parent) const {
     order.clear();
     treeEdges.clear();
     parent.assign(n_ + 1, 0);
 
-    std::vector<bool> visited(n_ + 1, false);
+    GraphVector<bool> visited(n_ + 1, false);
     std::queue<int> q;
     visited[start] = true;
     q.push(start);
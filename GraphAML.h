@@ -1,38 +1,41 @@
 #ifndef GRAPH_AML_H
 #define GRAPH_AML_H
 
+#include "GraphAllocator.h"
+#include "Utils.h"
+
 #include <utility>
 #include <vector>
 
+// 邻接多重表边结点：端点与权重直接取自共享的 EdgeInput 数组，
+// 这里只保存两条链的下标（-1 表示链尾）
 struct AMLEdge {
-    int ivex;
-    int jvex;
-    int weight;
-    AMLEdge* ilink;
-    AMLEdge* jlink;
+    int ilink;
+    int jlink;
 };
 
 struct AMLVNode {
-    AMLEdge* firstEdge;
+    int firstEdge;
 };
 
+// 邻接多重表视图，不拷贝边数据，调用方需保证 edges 在视图存活期间有效
 class GraphAML {
 public:
     GraphAML();
-    ~GraphAML();
 
-    void Init(int n);
-    void AddEdge(int u, int v, int w);
+    void Build(int n, const std::vector<EdgeInput>& edges);
+    void Clear();
     bool IsReady() const;
     int VertexCount() const;
 
     void BFS(int start, std::vector<int>& order, std::vector<std::pair<int, int>>& treeEdges,
-             std::vector<int>& parent) const;
+             GraphVector<int>& parent) const;
 
 private:
     int n_;
-    std::vector<AMLVNode> vertices_;
-    std::vector<AMLEdge*> edges_;
+    const std::vector<EdgeInput>* edges_;
+    GraphVector<AMLVNode> vertices_;
+    GraphVector<AMLEdge> links_;
 
     std::vector<int> CollectNeighbors(int v) const;
 };
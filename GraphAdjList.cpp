@@ -1,8 +1,10 @@
 ﻿#include "GraphAdjList.h"
 
 #include "MyStack.h"
+#include "Parallel.h"
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <functional>
 #include <iostream>
@@ -10,28 +12,114 @@
 #include <set>
 #include <unordered_set>
 
-GraphAdjList::GraphAdjList() : n_(0) {}
+GraphAdjList::GraphAdjList() : n_(0), generation_(0) {}
 
-void GraphAdjList::Init(int n) {
-    n_ = n;
-    adj_.assign(n_ + 1, {});
+static uint64_t NextGeneration() {
+    static std::atomic<uint64_t> counter{0};
+    return ++counter;
 }
 
-void GraphAdjList::AddEdge(int u, int v, int w) {
-    if (u < 1 || v < 1 || u > n_ || v > n_) {
-        return;
-    }
-    adj_[u].push_back({v, w});
-    adj_[v].push_back({u, w});
+static bool ValidEdge(const EdgeInput& e, int n) {
+    return e.u >= 1 && e.v >= 1 && e.u <= n && e.v <= n;
 }
 
-//对邻接表排序,有多个未访问邻居时按升序访问
-void GraphAdjList::SortAdjacency() {
-    for (auto& list : adj_) {
-        std::sort(list.begin(), list.end(), [](const AdjEdge& a, const AdjEdge& b) {
-            return a.to < b.to;
-        });
+unsigned GraphAdjList::Build(int n, const std::vector<EdgeInput>& edges, unsigned threads) {
+    n_ = n;
+    generation_ = NextGeneration();
+    threads = ResolveThreadCount(threads);
+    if (edges.size() < kParallelBuildThreshold) {
+        threads = 1;
+    }
+
+    // 1. 度数统计，顶点 v 的度数先记在 offsets_[v + 1]
+    offsets_.assign(static_cast<size_t>(n_) + 2, 0);
+    ParallelFor(0, edges.size(), threads, [&](unsigned, size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            const EdgeInput& e = edges[i];
+            if (!ValidEdge(e, n_)) {
+                continue;
+            }
+            std::atomic_ref<size_t>(offsets_[e.u + 1]).fetch_add(1, std::memory_order_relaxed);
+            std::atomic_ref<size_t>(offsets_[e.v + 1]).fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    // 2. 分块前缀和：各块先求局部和，再串行累加块和，最后回填
+    std::vector<size_t> blockSum(threads, 0);
+    ParallelFor(0, offsets_.size(), threads, [&](unsigned tid, size_t lo, size_t hi) {
+        size_t sum = 0;
+        for (size_t i = lo; i < hi; ++i) {
+            sum += offsets_[i];
+            offsets_[i] = sum;
+        }
+        blockSum[tid] = sum;
+    });
+    for (size_t t = 1; t < blockSum.size(); ++t) {
+        blockSum[t] += blockSum[t - 1];
+    }
+    ParallelFor(0, offsets_.size(), threads, [&](unsigned tid, size_t lo, size_t hi) {
+        if (tid == 0) {
+            return;
+        }
+        size_t base = blockSum[tid - 1];
+        for (size_t i = lo; i < hi; ++i) {
+            offsets_[i] += base;
+        }
+    });
+
+    // 按边数而不是顶点数把顶点切成 threads 段，避免高度数顶点集中在同一线程
+    // 首次访问填充与排序都使用这一切分
+    size_t slots = offsets_.back();
+    std::vector<size_t> bounds(threads + 1, static_cast<size_t>(n_) + 1);
+    bounds[0] = 1;
+    for (unsigned t = 1; t < threads; ++t) {
+        size_t target = slots / threads * t;
+        auto it = std::lower_bound(offsets_.begin() + 1, offsets_.end() - 1, target);
+        bounds[t] = std::max(bounds[t - 1], static_cast<size_t>(it - offsets_.begin()));
+    }
+
+    // resize 只做默认初始化；首次访问策略下由固定在各 CPU 上的线程
+    // 清零自己负责的那一段，页面落在之后排序该段的线程所在节点
+    const bool firstTouch = GetGraphNumaPolicy() == NumaPolicy::FirstTouch;
+    GraphUninitVector<AdjEdge>().swap(adj_);
+    adj_.resize(slots);
+    if (firstTouch) {
+        ParallelFor(0, threads, threads, [&](unsigned, size_t lo, size_t hi) {
+            for (size_t part = lo; part < hi; ++part) {
+                std::fill(adj_.begin() + offsets_[bounds[part]], adj_.begin() + offsets_[bounds[part + 1]],
+                          AdjEdge{0, 0});
+            }
+        }, true);
     }
+
+    // 3. 散射：每个顶点一个写游标，原子递增得到写入位置
+    GraphVector<size_t> cursor(offsets_.begin(), offsets_.end() - 1);
+    ParallelFor(0, edges.size(), threads, [&](unsigned, size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            const EdgeInput& e = edges[i];
+            if (!ValidEdge(e, n_)) {
+                continue;
+            }
+            size_t pu = std::atomic_ref<size_t>(cursor[e.u]).fetch_add(1, std::memory_order_relaxed);
+            size_t pv = std::atomic_ref<size_t>(cursor[e.v]).fetch_add(1, std::memory_order_relaxed);
+            adj_[pu] = {e.v, e.w};
+            adj_[pv] = {e.u, e.w};
+        }
+    });
+    GraphVector<size_t>().swap(cursor);
+
+    // 4. 邻接表排序，有多个未访问邻居时按升序访问
+    ParallelFor(0, threads, threads, [&](unsigned, size_t lo, size_t hi) {
+        for (size_t part = lo; part < hi; ++part) {
+            for (size_t v = bounds[part]; v < bounds[part + 1]; ++v) {
+                std::sort(adj_.begin() + offsets_[v], adj_.begin() + offsets_[v + 1],
+                          [](const AdjEdge& a, const AdjEdge& b) {
+                              return a.to != b.to ? a.to < b.to : a.weight < b.weight;
+                          });
+            }
+        }
+    }, firstTouch);
+    return threads;
 }
 
 bool GraphAdjList::IsReady() const {
@@ -42,14 +130,23 @@ int GraphAdjList::VertexCount() const {
     return n_;
 }
 
-const std::vector<std::vector<AdjEdge>>& GraphAdjList::Adj() const {
-    return adj_;
+uint64_t GraphAdjList::Generation() const {
+    return generation_;
+}
+
+std::span<const AdjEdge> GraphAdjList::Neighbors(int v) const {
+    return {adj_.data() + offsets_[v], offsets_[v + 1] - offsets_[v]};
+}
+
+//邻接表中的边槽数，无向边各占两个
+size_t GraphAdjList::EdgeSlotCount() const {
+    return adj_.size();
 }
 
 void GraphAdjList::Show() const {
     for (int v = 1; v <= n_; ++v) {
         std::cout << v << ":";
-        for (const auto& e : adj_[v]) {
+        for (const auto& e : Neighbors(v)) {
             std::cout << " (" << e.to << "," << e.weight << ")";
         }
         std::cout << "\n";
@@ -68,7 +165,7 @@ void GraphAdjList::ExportGraphDot(const std::string& path) const {
     }
     std::unordered_set<long long> seen;
     for (int u = 1; u <= n_; ++u) {
-        for (const auto& e : adj_[u]) {
+        for (const auto& e : Neighbors(u)) {
             int v = e.to;
             int a = u < v ? u : v;
             int b = u < v ? v : u;
@@ -84,12 +181,12 @@ void GraphAdjList::ExportGraphDot(const std::string& path) const {
 }
 
 void GraphAdjList::BFS(int start, std::vector<int>& order, std::vector<std::pair<int, int>>& treeEdges,
-                       std::vector<int>& parent) const {
+                       GraphVector<int>& parent) const {
     order.clear();
     treeEdges.clear();
     parent.assign(n_ + 1, 0);
 
-    std::vector<bool> visited(n_ + 1, false);
+    GraphVector<bool> visited(n_ + 1, false);
     std::queue<int> q;
     visited[start] = true;
     q.push(start);
@@ -98,7 +195,7 @@ void GraphAdjList::BFS(int start, std::vector<int>& order, std::vector<std::pair
         int v = q.front();
         q.pop();
         order.push_back(v);
-        for (const auto& e : adj_[v]) {
+        for (const auto& e : Neighbors(v)) {
             int to = e.to;
             if (!visited[to]) {
                 visited[to] = true;
@@ -112,11 +209,11 @@ void GraphAdjList::BFS(int start, std::vector<int>& order, std::vector<std::pair
 
 void GraphAdjList::DFSIterative(int start, std::vector<int>& order,
                                 std::vector<std::pair<int, int>>& treeEdges,
-                                std::vector<int>& parent) const {
+                                GraphVector<int>& parent) const {
     order.clear();
     treeEdges.clear();
     parent.assign(n_ + 1, 0);
-    std::vector<bool> visited(n_ + 1, false);
+    GraphVector<bool> visited(n_ + 1, false);
 
     //栈帧结构
     struct Frame {
@@ -131,13 +228,14 @@ void GraphAdjList::DFSIterative(int start, std::vector<int>& order,
 
     while (!stack.empty()) {
         Frame& frame = stack.top();
+        std::span<const AdjEdge> neighbors = Neighbors(frame.v);
         int v = frame.v;
-        if (frame.nextIdx >= adj_[v].size()) {
+        if (frame.nextIdx >= neighbors.size()) {
             stack.pop();
             continue;
         }
 
-        const AdjEdge& edge = adj_[v][frame.nextIdx];
+        const AdjEdge& edge = neighbors[frame.nextIdx];
         ++frame.nextIdx;
         int to = edge.to;
         if (!visited[to]) {
@@ -150,6 +248,101 @@ void GraphAdjList::DFSIterative(int start, std::vector<int>& order,
     }
 }
 
+void GraphAdjList::LowLink(LowLinkResult& result) const {
+    LowLinkWorkspace workspace;
+    LowLink(result, workspace);
+}
+
+void GraphAdjList::LowLink(LowLinkResult& result, LowLinkWorkspace& workspace) const {
+    result.bridges.clear();
+    result.articulationPoints.clear();
+    result.bccEdges.clear();
+    result.bccOffsets.assign(1, 0);
+
+    // disc 为 0 表示未访问
+    GraphVector<int> disc(n_ + 1, 0);
+    GraphVector<int> low(n_ + 1, 0);
+    GraphVector<char> isCut(n_ + 1, 0);
+    int timer = 0;
+
+    using Frame = LowLinkWorkspace::Frame;
+    MyStack<Frame>& stack = workspace.frames;
+    MyStack<std::pair<int, int>>& edgeStack = workspace.edges;
+    stack.clear();
+    edgeStack.clear();
+
+    for (int root = 1; root <= n_; ++root) {
+        if (disc[root] != 0) {
+            continue;
+        }
+        disc[root] = low[root] = ++timer;
+        stack.push({root, 0, 0});
+        int rootChildren = 0;
+
+        while (!stack.empty()) {
+            Frame& frame = stack.top();
+            int v = frame.v;
+            std::span<const AdjEdge> neighbors = Neighbors(v);
+            if (frame.nextIdx < neighbors.size()) {
+                int to = neighbors[frame.nextIdx].to;
+                ++frame.nextIdx;
+                if (to == frame.skipParent) {
+                    frame.skipParent = 0;
+                    continue;
+                }
+                if (disc[to] == 0) {
+                    if (v == root) {
+                        ++rootChildren;
+                    }
+                    disc[to] = low[to] = ++timer;
+                    edgeStack.push({v, to});
+                    stack.push({to, v, 0});
+                } else if (disc[to] < disc[v]) {
+                    // 回边，指向祖先
+                    edgeStack.push({v, to});
+                    low[v] = std::min(low[v], disc[to]);
+                }
+                continue;
+            }
+
+            // v 的邻接边处理完毕，回溯到父节点更新 low 值
+            stack.pop();
+            if (stack.empty()) {
+                break;
+            }
+            int p = stack.top().v;
+            low[p] = std::min(low[p], low[v]);
+            if (low[v] > disc[p]) {
+                result.bridges.push_back({p, v});
+            }
+            if (low[v] >= disc[p]) {
+                if (p != root) {
+                    isCut[p] = 1;
+                }
+                // 弹出直到树边 (p, v)，得到一个点双连通分量
+                while (true) {
+                    std::pair<int, int> e = edgeStack.top();
+                    edgeStack.pop();
+                    result.bccEdges.push_back(e);
+                    if (e.first == p && e.second == v) {
+                        break;
+                    }
+                }
+                result.bccOffsets.push_back(result.bccEdges.size());
+            }
+        }
+        if (rootChildren >= 2) {
+            isCut[root] = 1;
+        }
+    }
+
+    for (int v = 1; v <= n_; ++v) {
+        if (isCut[v]) {
+            result.articulationPoints.push_back(v);
+        }
+    }
+}
+
 void GraphAdjList::ExportTreeDot(const std::string& path, const std::vector<std::pair<int, int>>& treeEdges) const {
     std::ofstream out(path);
     if (!out.is_open()) {
@@ -166,13 +359,12 @@ void GraphAdjList::ExportTreeDot(const std::string& path, const std::vector<std:
     out << "}\n";
 }
 
-void GraphAdjList::Dijkstra(int start, std::vector<int>& parent, std::vector<long long>& dist) const {
-    const long long INF = static_cast<long long>(4e18);
-    dist.assign(n_ + 1, INF);
+void GraphAdjList::Dijkstra(int start, GraphVector<int>& parent, GraphVector<long long>& dist) const {
+    dist.assign(n_ + 1, kInfDist);
     parent.assign(n_ + 1, 0);
 
     using Node = std::pair<long long, int>;
-    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> pq;
+    std::priority_queue<Node, GraphVector<Node>, std::greater<Node>> pq;
 
     dist[start] = 0;
     pq.push({0, start});
@@ -183,7 +375,7 @@ void GraphAdjList::Dijkstra(int start, std::vector<int>& parent, std::vector<lon
         if (d != dist[v]) {
             continue;
         }
-        for (const auto& e : adj_[v]) {
+        for (const auto& e : Neighbors(v)) {
             int to = e.to;
             long long nd = d + e.weight;
             // Dijkstra 松弛：若找到更短距离则更新 parent
@@ -197,19 +389,16 @@ void GraphAdjList::Dijkstra(int start, std::vector<int>& parent, std::vector<lon
 }
 
 void GraphAdjList::ExportShortestPathDot(const std::string& path, int s, int t,
-                                         const std::vector<int>& parent) const {
-    int cur = t;
+                                         const GraphVector<int>& parent) const {
+    ExportPathDot(path, RebuildPath(parent, s, t));
+}
 
+void GraphAdjList::ExportPathDot(const std::string& path, const std::vector<int>& pathVertices) const {
     std::set<std::pair<int, int>> pathEdges;
-    while (cur != 0 && cur != s) {
-        int p = parent[cur];
-        if (p == 0) {
-            break;
-        }
-        int a = p < cur ? p : cur;
-        int b = p < cur ? cur : p;
+    for (size_t i = 1; i < pathVertices.size(); ++i) {
+        int a = pathVertices[i - 1] < pathVertices[i] ? pathVertices[i - 1] : pathVertices[i];
+        int b = pathVertices[i - 1] < pathVertices[i] ? pathVertices[i] : pathVertices[i - 1];
         pathEdges.insert({a, b});
-        cur = p;
     }
 
     std::ofstream out(path);
@@ -224,7 +413,7 @@ void GraphAdjList::ExportShortestPathDot(const std::string& path, int s, int t,
 
     std::unordered_set<long long> seen;
     for (int u = 1; u <= n_; ++u) {
-        for (const auto& e : adj_[u]) {
+        for (const auto& e : Neighbors(u)) {
             int v = e.to;
             int a = u < v ? u : v;
             int b = u < v ? v : u;
@@ -1,6 +1,13 @@
 #ifndef GRAPH_ADJLIST_H
 #define GRAPH_ADJLIST_H
 
+#include "GraphAllocator.h"
+#include "MyStack.h"
+#include "Utils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -10,36 +17,82 @@ struct AdjEdge {
     int weight;
 };
 
+// 低链接分析结果：桥、割点与点双连通分量
+struct LowLinkResult {
+    std::vector<std::pair<int, int>> bridges;
+    std::vector<int> articulationPoints;
+    // 第 k 个点双连通分量的边为 bccEdges[bccOffsets[k], bccOffsets[k + 1])
+    std::vector<std::pair<int, int>> bccEdges;
+    std::vector<size_t> bccOffsets;
+};
+
+// LowLink 的可复用工作区，多次调用之间保留两个栈已分配的块
+struct LowLinkWorkspace {
+    //栈帧结构，父节点取自栈中下一层
+    struct Frame {
+        int v;//当前处理的节点
+        int skipParent;//尚未跳过的父节点，跳过一次后置 0，重边仍按回边处理
+        size_t nextIdx;//下次要处理的邻接边的下标
+    };
+
+    MyStack<Frame> frames;
+    MyStack<std::pair<int, int>> edges;
+
+    // 归还两个栈的全部块，换图后调用
+    void Release() {
+        frames.release();
+        edges.release();
+    }
+};
+
 class GraphAdjList {
 public:
+    // Dijkstra 中不可达顶点的距离
+    static constexpr long long kInfDist = 4000000000000000000LL;
+    // 边数低于该值时线程开销大于收益，Build 直接串行
+    static constexpr size_t kParallelBuildThreshold = static_cast<size_t>(1) << 15;
+
     GraphAdjList();
 
-    void Init(int n);
-    void AddEdge(int u, int v, int w);
-    void SortAdjacency();
+    // 按 CSR 布局建图：统计度数、前缀和求偏移、并行散射、并行排序邻接表
+    // threads 为 0 时使用硬件并发数，返回实际使用的线程数
+    unsigned Build(int n, const std::vector<EdgeInput>& edges, unsigned threads = 0);
 
     bool IsReady() const;
     int VertexCount() const;
+    // 每次 Build 都会得到新的全局唯一编号，缓存据此判断图是否变化
+    uint64_t Generation() const;
 
     void Show() const;
     void ExportGraphDot(const std::string& path) const;
 
     void BFS(int start, std::vector<int>& order, std::vector<std::pair<int, int>>& treeEdges,
-             std::vector<int>& parent) const;
+             GraphVector<int>& parent) const;
     void DFSIterative(int start, std::vector<int>& order, std::vector<std::pair<int, int>>& treeEdges,
-                      std::vector<int>& parent) const;
+                      GraphVector<int>& parent) const;
+
+    // 非递归 Tarjan 低链接分析，线性时间，覆盖所有连通分量
+    void LowLink(LowLinkResult& result, LowLinkWorkspace& workspace) const;
+    // 使用临时工作区
+    void LowLink(LowLinkResult& result) const;
 
     void ExportTreeDot(const std::string& path, const std::vector<std::pair<int, int>>& treeEdges) const;
 
-    void Dijkstra(int start, std::vector<int>& parent, std::vector<long long>& dist) const;
+    void Dijkstra(int start, GraphVector<int>& parent, GraphVector<long long>& dist) const;
     void ExportShortestPathDot(const std::string& path, int s, int t,
-                               const std::vector<int>& parent) const;
+                               const GraphVector<int>& parent) const;
+    // 导出整张图，并高亮 pathVertices 依次相连的路径边
+    void ExportPathDot(const std::string& path, const std::vector<int>& pathVertices) const;
 
-    const std::vector<std::vector<AdjEdge>>& Adj() const;
+    std::span<const AdjEdge> Neighbors(int v) const;
+    size_t EdgeSlotCount() const;
 
 private:
     int n_;
-    std::vector<std::vector<AdjEdge>> adj_;
+    uint64_t generation_;
+    // 顶点 v 的邻居存放在 adj_[offsets_[v], offsets_[v + 1])
+    GraphVector<size_t> offsets_;
+    GraphUninitVector<AdjEdge> adj_;
 };
 
 #endif
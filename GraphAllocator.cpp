@@ -0,0 +1,251 @@
+#include "GraphAllocator.h"
+
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const size_t kHugePageSize = static_cast<size_t>(2) << 20;
+//小于一个大页的分配仍走默认分配器
+const size_t kMinMappedBytes = kHugePageSize;
+
+std::atomic<int> gPagePolicy{static_cast<int>(PagePolicy::Default)};
+std::atomic<int> gNumaPolicy{static_cast<int>(NumaPolicy::Default)};
+
+std::atomic<uint64_t> gHugetlbBytes{0};
+std::atomic<uint64_t> gThpAdvisedBytes{0};
+std::atomic<uint64_t> gInterleaveBytes{0};
+std::atomic<uint64_t> gFallbacks{0};
+
+//记录 mmap 得到的区域及其映射长度，释放时据此选择 munmap
+std::mutex gMappedMutex;
+std::unordered_map<void*, size_t> gMapped;
+
+size_t RoundUp(size_t bytes, size_t align) {
+    return (bytes + align - 1) / align * align;
+}
+
+#ifdef __linux__
+
+const int kMpolInterleave = 3;
+
+//解析 /sys/devices/system/node/online，例如 "0-1,3"
+std::vector<unsigned long> OnlineNodeMask(int& nodeCount) {
+    std::vector<unsigned long> mask;
+    nodeCount = 0;
+    std::ifstream in("/sys/devices/system/node/online");
+    std::string text;
+    if (!(in >> text)) {
+        return mask;
+    }
+    const size_t bits = sizeof(unsigned long) * 8;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t comma = text.find(',', pos);
+        std::string part = text.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        size_t dash = part.find('-');
+        int lo = std::stoi(part.substr(0, dash));
+        int hi = dash == std::string::npos ? lo : std::stoi(part.substr(dash + 1));
+        for (int node = lo; node <= hi; ++node) {
+            size_t word = static_cast<size_t>(node) / bits;
+            if (mask.size() <= word) {
+                mask.resize(word + 1, 0);
+            }
+            mask[word] |= 1UL << (static_cast<size_t>(node) % bits);
+            ++nodeCount;
+        }
+        if (comma == std::string::npos) {
+            break;
+        }
+        pos = comma + 1;
+    }
+    return mask;
+}
+
+bool InterleaveRange(void* addr, size_t len) {
+    static int nodeCount = 0;
+    static const std::vector<unsigned long> mask = OnlineNodeMask(nodeCount);
+    if (nodeCount < 2) {
+        return false;
+    }
+    unsigned long maxNode = static_cast<unsigned long>(mask.size() * sizeof(unsigned long) * 8 + 1);
+    return syscall(SYS_mbind, addr, len, kMpolInterleave, mask.data(), maxNode, 0) == 0;
+}
+
+//映射按 2 MiB 对齐的匿名内存，透明大页只能作用于对齐的整页
+void* MapAligned(size_t len) {
+    size_t total = len + kHugePageSize;
+    void* raw = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+    uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned = RoundUp(start, kHugePageSize);
+    size_t head = aligned - start;
+    size_t tail = total - head - len;
+    if (head > 0) {
+        munmap(raw, head);
+    }
+    if (tail > 0) {
+        munmap(reinterpret_cast<void*>(aligned + len), tail);
+    }
+    return reinterpret_cast<void*>(aligned);
+}
+
+void* MapRegion(size_t len, PagePolicy pages) {
+    if (pages == PagePolicy::ExplicitHuge) {
+        void* p = mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            gHugetlbBytes += len;
+            return p;
+        }
+        // 大页池不足或未配置，退回透明大页
+        ++gFallbacks;
+        pages = PagePolicy::TransparentHuge;
+    }
+    void* p = MapAligned(len);
+    if (p == nullptr) {
+        return nullptr;
+    }
+    if (pages == PagePolicy::TransparentHuge) {
+        if (madvise(p, len, MADV_HUGEPAGE) == 0) {
+            gThpAdvisedBytes += len;
+        } else {
+            ++gFallbacks;
+        }
+    }
+    return p;
+}
+
+#endif
+
+}  // namespace
+
+void SetGraphMemoryPolicy(PagePolicy pages, NumaPolicy numa) {
+    gPagePolicy = static_cast<int>(pages);
+    gNumaPolicy = static_cast<int>(numa);
+}
+
+PagePolicy GetGraphPagePolicy() {
+    return static_cast<PagePolicy>(gPagePolicy.load());
+}
+
+NumaPolicy GetGraphNumaPolicy() {
+    return static_cast<NumaPolicy>(gNumaPolicy.load());
+}
+
+GraphMemoryStats GetGraphMemoryStats() {
+    GraphMemoryStats stats;
+    stats.hugetlbBytes = gHugetlbBytes.load();
+    stats.thpAdvisedBytes = gThpAdvisedBytes.load();
+    stats.interleaveBytes = gInterleaveBytes.load();
+    stats.fallbacks = gFallbacks.load();
+    return stats;
+}
+
+long long ReadAnonHugePagesBytes() {
+    std::ifstream in("/proc/self/smaps_rollup");
+    std::string key;
+    while (in >> key) {
+        if (key == "AnonHugePages:") {
+            long long kb = 0;
+            if (in >> kb) {
+                return kb * 1024;
+            }
+            return -1;
+        }
+        std::getline(in, key);
+    }
+    return -1;
+}
+
+const char* PagePolicyName(PagePolicy pages) {
+    switch (pages) {
+    case PagePolicy::TransparentHuge:
+        return "透明大页";
+    case PagePolicy::ExplicitHuge:
+        return "显式大页";
+    default:
+        return "默认页";
+    }
+}
+
+const char* NumaPolicyName(NumaPolicy numa) {
+    switch (numa) {
+    case NumaPolicy::Interleave:
+        return "交错分配";
+    case NumaPolicy::FirstTouch:
+        return "首次访问";
+    default:
+        return "默认";
+    }
+}
+
+void* GraphAllocate(size_t bytes) {
+    PagePolicy pages = GetGraphPagePolicy();
+    NumaPolicy numa = GetGraphNumaPolicy();
+    // 首次访问由使用方负责写入，这里只处理大页与交错策略
+    bool custom = pages != PagePolicy::Default || numa == NumaPolicy::Interleave;
+    if (!custom || bytes < kMinMappedBytes) {
+        return ::operator new(bytes);
+    }
+
+#ifdef __linux__
+    size_t len = RoundUp(bytes, kHugePageSize);
+    void* p = MapRegion(len, pages);
+    if (p == nullptr) {
+        ++gFallbacks;
+        return ::operator new(bytes);
+    }
+    if (numa == NumaPolicy::Interleave) {
+        if (InterleaveRange(p, len)) {
+            gInterleaveBytes += len;
+        } else {
+            ++gFallbacks;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(gMappedMutex);
+        gMapped[p] = len;
+    }
+    return p;
+#else
+    ++gFallbacks;
+    return ::operator new(bytes);
+#endif
+}
+
+void GraphDeallocate(void* p, size_t bytes) noexcept {
+    if (p == nullptr) {
+        return;
+    }
+#ifdef __linux__
+    size_t len = 0;
+    // 映射区域都不小于 kMinMappedBytes，小块无需查表
+    if (bytes >= kMinMappedBytes) {
+        std::lock_guard<std::mutex> lock(gMappedMutex);
+        auto it = gMapped.find(p);
+        if (it != gMapped.end()) {
+            len = it->second;
+            gMapped.erase(it);
+        }
+    }
+    if (len > 0) {
+        munmap(p, len);
+        return;
+    }
+#else
+    (void)bytes;
+#endif
+    ::operator delete(p);
+}
@@ -0,0 +1,108 @@
+#ifndef GRAPH_ALLOCATOR_H
+#define GRAPH_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 大页策略：默认 4 KiB 页、透明大页（madvise）、显式大页（MAP_HUGETLB）
+enum class PagePolicy {
+    Default,
+    TransparentHuge,
+    ExplicitHuge,
+};
+
+// NUMA 策略：系统默认、跨节点交错、首次访问
+// 首次访问不在分配时写入页面：建图时由固定 CPU 的线程按排序切分先写邻接数组，
+// 串行遍历使用的缓冲区仍由调用线程写入
+enum class NumaPolicy {
+    Default,
+    Interleave,
+    FirstTouch,
+};
+
+struct GraphMemoryStats {
+    uint64_t hugetlbBytes = 0;//通过 MAP_HUGETLB 得到的字节数
+    uint64_t thpAdvisedBytes = 0;//madvise(MADV_HUGEPAGE) 成功的字节数，不代表实际得到了大页
+    uint64_t interleaveBytes = 0;//成功设置交错策略的字节数
+    uint64_t fallbacks = 0;//请求的策略不可用而退回的次数
+};
+
+// 策略只影响之后的分配，已分配的内存按原方式释放
+// 不支持的平台（非 Linux）上所有策略都退回默认分配
+void SetGraphMemoryPolicy(PagePolicy pages, NumaPolicy numa);
+PagePolicy GetGraphPagePolicy();
+NumaPolicy GetGraphNumaPolicy();
+GraphMemoryStats GetGraphMemoryStats();
+// 从 /proc/self/smaps_rollup 读取进程实际使用的透明大页字节数（AnonHugePages），不可用时返回 -1
+long long ReadAnonHugePagesBytes();
+const char* PagePolicyName(PagePolicy pages);
+const char* NumaPolicyName(NumaPolicy numa);
+
+void* GraphAllocate(size_t bytes);
+void GraphDeallocate(void* p, size_t bytes) noexcept;
+
+// 图存储与遍历缓冲区使用的分配器，元素初始化方式与 std::allocator 相同
+template <typename T>
+class GraphAllocator {
+public:
+    using value_type = T;
+
+    GraphAllocator() noexcept = default;
+
+    template <typename U>
+    GraphAllocator(const GraphAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(GraphAllocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        GraphDeallocate(p, n * sizeof(T));
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const GraphAllocator<T>&, const GraphAllocator<U>&) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const GraphAllocator<T>&, const GraphAllocator<U>&) noexcept {
+    return false;
+}
+
+template <typename T>
+using GraphVector = std::vector<T, GraphAllocator<T>>;
+
+// 无参 construct 只做默认初始化：resize 不写入元素，页面留给真正填数据的线程首次访问
+// 只用于建图时随后会被完整覆盖的数组，其他地方请用 GraphVector
+template <typename T>
+class GraphUninitAllocator : public GraphAllocator<T> {
+public:
+    GraphUninitAllocator() noexcept = default;
+
+    template <typename U>
+    GraphUninitAllocator(const GraphUninitAllocator<U>&) noexcept {}
+
+    template <typename U>
+    void construct(U* p) noexcept(std::is_nothrow_default_constructible_v<U>) {
+        ::new (static_cast<void*>(p)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
+template <typename T>
+using GraphUninitVector = std::vector<T, GraphUninitAllocator<T>>;
+
+#endif
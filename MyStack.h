@@ -1,39 +1,136 @@
 #ifndef MYSTACK_H
 #define MYSTACK_H
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
 #include <vector>
 
 // 自定义栈，禁止使用 std::stack
-// 底层使用 vector 以满足非递归 DFS 的需求
+// 底层按块存储：首块约 256 字节，之后每块翻倍，单块最大约 1 MiB。
+// 扩容只新增一块，已有元素不会被拷贝，引用在 push 之后依然有效，
+// 适合非递归 DFS 这类可能很深的栈。
+// pop/clear 会析构元素但不释放块，同一个栈可以反复使用；release 才归还内存
 template <typename T>
 class MyStack {
 public:
+    MyStack() = default;
+
+    ~MyStack() {
+        release();
+    }
+
+    MyStack(const MyStack&) = delete;
+    MyStack& operator=(const MyStack&) = delete;
+
     void push(const T& value) {
-        data_.push_back(value);
+        if (chunks_.empty()) {
+            AddChunk(NextChunkSize());
+        } else if (offset_ == chunks_[cur_].cap) {
+            if (cur_ + 1 == chunks_.size()) {
+                AddChunk(NextChunkSize());
+            }
+            ++cur_;
+            offset_ = 0;
+        }
+        ::new (static_cast<void*>(chunks_[cur_].data + offset_)) T(value);
+        ++offset_;
+        ++size_;
     }
 
     void pop() {
-        data_.pop_back();
+        --offset_;
+        --size_;
+        chunks_[cur_].data[offset_].~T();
+        // 当前块空了就回到前一块的末尾，保证 top 总在 offset_ - 1
+        if (offset_ == 0 && cur_ > 0) {
+            --cur_;
+            offset_ = chunks_[cur_].cap;
+        }
     }
 
     T& top() {
-        return data_.back();
+        return chunks_[cur_].data[offset_ - 1];
     }
 
     const T& top() const {
-        return data_.back();
+        return chunks_[cur_].data[offset_ - 1];
     }
 
     bool empty() const {
-        return data_.empty();
+        return size_ == 0;
     }
 
     size_t size() const {
-        return data_.size();
+        return size_;
+    }
+
+    // 预先分配至少 n 个元素的空间，按正常增长规则追加块，单块不超过上限
+    void reserve(size_t n) {
+        while (capacity_ < n) {
+            AddChunk(std::min(std::max(n - capacity_, NextChunkSize()), kMaxChunkSize));
+        }
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    // 清空元素但保留已分配的块
+    void clear() {
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            size_ = 0;
+            cur_ = 0;
+            offset_ = 0;
+        } else {
+            while (!empty()) {
+                pop();
+            }
+        }
+    }
+
+    // 清空并释放所有块
+    void release() {
+        clear();
+        std::allocator<T> alloc;
+        for (const Chunk& chunk : chunks_) {
+            alloc.deallocate(chunk.data, chunk.cap);
+        }
+        chunks_.clear();
+        chunks_.shrink_to_fit();
+        capacity_ = 0;
     }
 
 private:
-    std::vector<T> data_;
+    struct Chunk {
+        T* data;
+        size_t cap;
+    };
+
+    static constexpr size_t kFirstChunkBytes = 256;
+    static constexpr size_t kMaxChunkBytes = static_cast<size_t>(1) << 20;
+    static constexpr size_t kFirstChunkSize = std::max<size_t>(1, kFirstChunkBytes / sizeof(T));
+    static constexpr size_t kMaxChunkSize = std::max<size_t>(1, kMaxChunkBytes / sizeof(T));
+
+    std::vector<Chunk> chunks_;
+    size_t cur_ = 0;//栈顶所在块
+    size_t offset_ = 0;//栈顶所在块中已使用的元素个数
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+
+    size_t NextChunkSize() const {
+        if (chunks_.empty()) {
+            return kFirstChunkSize;
+        }
+        return std::min(chunks_.back().cap * 2, kMaxChunkSize);
+    }
+
+    void AddChunk(size_t cap) {
+        chunks_.push_back({std::allocator<T>().allocate(cap), cap});
+        capacity_ += cap;
+    }
 };
 
 #endif
@@ -0,0 +1,88 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// 线程数为 0 时使用硬件并发数
+inline unsigned ResolveThreadCount(unsigned threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    return threads == 0 ? 1 : threads;
+}
+
+// 把当前线程固定到进程可用 CPU 中的第 tid 个（取模），失败或非 Linux 时不做处理
+inline void PinCurrentThread(unsigned tid) {
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return;
+    }
+    int count = CPU_COUNT(&allowed);
+    if (count <= 0) {
+        return;
+    }
+    int target = static_cast<int>(tid % static_cast<unsigned>(count));
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed) && target-- == 0) {
+            cpu_set_t one;
+            CPU_ZERO(&one);
+            CPU_SET(cpu, &one);
+            pthread_setaffinity_np(pthread_self(), sizeof(one), &one);
+            return;
+        }
+    }
+#else
+    (void)tid;
+#endif
+}
+
+// 把 [begin, end) 均分给 threads 个线程，fn(tid, lo, hi) 处理一段
+// threads 为 1 时直接在当前线程执行
+// pinThreads 为 true 时每段都在新线程中运行并固定到第 tid 个 CPU，
+// 同样的 (begin, end, threads) 两次调用时同一段落在同一个 CPU 上
+template <typename Fn>
+void ParallelFor(size_t begin, size_t end, unsigned threads, Fn fn, bool pinThreads = false) {
+    if (end <= begin) {
+        return;
+    }
+    size_t total = end - begin;
+    threads = static_cast<unsigned>(std::min<size_t>(threads == 0 ? 1 : threads, total));
+    if (threads == 1) {
+        fn(0u, begin, end);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    size_t chunk = total / threads;
+    size_t extra = total % threads;
+    size_t lo = begin;
+    for (unsigned t = 0; t < threads; ++t) {
+        size_t hi = lo + chunk + (t < extra ? 1 : 0);
+        if (pinThreads) {
+            // 调用线程本身不固定，避免影响之后的工作
+            workers.emplace_back([&fn, t, lo, hi] {
+                PinCurrentThread(t);
+                fn(t, lo, hi);
+            });
+        } else if (t + 1 == threads) {
+            fn(t, lo, hi);
+        } else {
+            workers.emplace_back(fn, t, lo, hi);
+        }
+        lo = hi;
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+#endif
@@ -0,0 +1,202 @@
+#include "ShortestPathCache.h"
+
+#include "Utils.h"
+
+#include <algorithm>
+#include <cstring>
+
+void PackedArray::Assign(size_t count, uint64_t maxValue) {
+    if (maxValue <= UINT8_MAX) {
+        width_ = 1;
+    } else if (maxValue <= UINT16_MAX) {
+        width_ = 2;
+    } else if (maxValue <= UINT32_MAX) {
+        width_ = 4;
+    } else {
+        width_ = 8;
+    }
+    size_ = count;
+    data_.assign(count * width_, 0);
+    data_.shrink_to_fit();
+}
+
+void PackedArray::Set(size_t i, uint64_t value) {
+    unsigned char* p = data_.data() + i * width_;
+    switch (width_) {
+    case 1: {
+        uint8_t x = static_cast<uint8_t>(value);
+        std::memcpy(p, &x, sizeof(x));
+        break;
+    }
+    case 2: {
+        uint16_t x = static_cast<uint16_t>(value);
+        std::memcpy(p, &x, sizeof(x));
+        break;
+    }
+    case 4: {
+        uint32_t x = static_cast<uint32_t>(value);
+        std::memcpy(p, &x, sizeof(x));
+        break;
+    }
+    default:
+        std::memcpy(p, &value, sizeof(value));
+        break;
+    }
+}
+
+uint64_t PackedArray::Get(size_t i) const {
+    const unsigned char* p = data_.data() + i * width_;
+    switch (width_) {
+    case 1: {
+        uint8_t x;
+        std::memcpy(&x, p, sizeof(x));
+        return x;
+    }
+    case 2: {
+        uint16_t x;
+        std::memcpy(&x, p, sizeof(x));
+        return x;
+    }
+    case 4: {
+        uint32_t x;
+        std::memcpy(&x, p, sizeof(x));
+        return x;
+    }
+    default: {
+        uint64_t x;
+        std::memcpy(&x, p, sizeof(x));
+        return x;
+    }
+    }
+}
+
+size_t PackedArray::Size() const {
+    return size_;
+}
+
+size_t PackedArray::Bytes() const {
+    return data_.capacity();
+}
+
+void ShortestPathTree::Assign(int source, const GraphVector<int>& parent,
+                              const GraphVector<long long>& dist) {
+    source_ = source;
+    uint64_t maxDist = 0;
+    for (long long d : dist) {
+        if (d != GraphAdjList::kInfDist) {
+            maxDist = std::max(maxDist, static_cast<uint64_t>(d));
+        }
+    }
+    // parent 取值不超过顶点数
+    parent_.Assign(parent.size(), parent.empty() ? 0 : parent.size() - 1);
+    dist_.Assign(dist.size(), maxDist + 1);
+    for (size_t v = 0; v < parent.size(); ++v) {
+        parent_.Set(v, static_cast<uint64_t>(parent[v]));
+    }
+    for (size_t v = 0; v < dist.size(); ++v) {
+        dist_.Set(v, dist[v] == GraphAdjList::kInfDist ? 0 : static_cast<uint64_t>(dist[v]) + 1);
+    }
+}
+
+int ShortestPathTree::Source() const {
+    return source_;
+}
+
+int ShortestPathTree::VertexCount() const {
+    return parent_.Size() == 0 ? 0 : static_cast<int>(parent_.Size()) - 1;
+}
+
+int ShortestPathTree::Parent(int v) const {
+    return static_cast<int>(parent_.Get(static_cast<size_t>(v)));
+}
+
+long long ShortestPathTree::Dist(int v) const {
+    uint64_t d = dist_.Get(static_cast<size_t>(v));
+    return d == 0 ? GraphAdjList::kInfDist : static_cast<long long>(d - 1);
+}
+
+std::vector<int> ShortestPathTree::Path(int v) const {
+    return WalkParentPath([this](int x) { return Parent(x); }, VertexCount(), source_, v);
+}
+
+size_t ShortestPathTree::Bytes() const {
+    return parent_.Bytes() + dist_.Bytes();
+}
+
+ShortestPathCache::ShortestPathCache(size_t capacityBytes) : capacityBytes_(capacityBytes) {}
+
+//条目占用：两个压缩数组加上链表结点与哈希表项的近似开销
+size_t ShortestPathCache::EntryBytes(const ShortestPathTree& tree) {
+    return tree.Bytes() + sizeof(ShortestPathTree) + 2 * sizeof(void*) +
+           sizeof(std::pair<const int, std::list<ShortestPathTree>::iterator>) + sizeof(void*);
+}
+
+const ShortestPathTree& ShortestPathCache::Get(const GraphAdjList& graph, int source) {
+    if (graph.Generation() != generation_) {
+        Clear();
+        generation_ = graph.Generation();
+    }
+
+    auto it = index_.find(source);
+    if (it != index_.end()) {
+        ++hits_;
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return lru_.front();
+    }
+
+    ++misses_;
+    GraphVector<int> parent;
+    GraphVector<long long> dist;
+    graph.Dijkstra(source, parent, dist);
+    ShortestPathTree tree;
+    tree.Assign(source, parent, dist);
+    size_t entryBytes = EntryBytes(tree);
+    if (entryBytes > capacityBytes_) {
+        ++rejected_;
+        scratch_ = std::move(tree);
+        return scratch_;
+    }
+
+    // 先淘汰最久未使用的条目，腾出空间后再放入新条目
+    while (bytes_ + entryBytes > capacityBytes_ && !lru_.empty()) {
+        const ShortestPathTree& victim = lru_.back();
+        bytes_ -= EntryBytes(victim);
+        index_.erase(victim.Source());
+        lru_.pop_back();
+    }
+    lru_.push_front(std::move(tree));
+    index_[source] = lru_.begin();
+    bytes_ += entryBytes;
+    return lru_.front();
+}
+
+void ShortestPathCache::Clear() {
+    lru_.clear();
+    index_.clear();
+    bytes_ = 0;
+    scratch_ = ShortestPathTree();
+}
+
+uint64_t ShortestPathCache::Hits() const {
+    return hits_;
+}
+
+uint64_t ShortestPathCache::Misses() const {
+    return misses_;
+}
+
+uint64_t ShortestPathCache::Rejected() const {
+    return rejected_;
+}
+
+size_t ShortestPathCache::Bytes() const {
+    return bytes_;
+}
+
+size_t ShortestPathCache::CapacityBytes() const {
+    return capacityBytes_;
+}
+
+size_t ShortestPathCache::EntryCount() const {
+    return lru_.size();
+}
@@ -0,0 +1,83 @@
+#ifndef SHORTEST_PATH_CACHE_H
+#define SHORTEST_PATH_CACHE_H
+
+#include "GraphAdjList.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// 按最大值选用 1/2/4/8 字节宽度存储的无符号整数数组
+class PackedArray {
+public:
+    void Assign(size_t count, uint64_t maxValue);
+    void Set(size_t i, uint64_t value);
+    uint64_t Get(size_t i) const;
+    size_t Size() const;
+    size_t Bytes() const;
+
+private:
+    unsigned width_ = 1;
+    size_t size_ = 0;
+    std::vector<unsigned char> data_;
+};
+
+// 压缩存储的最短路径树，parent 与 dist 都按所需最小宽度保存
+class ShortestPathTree {
+public:
+    void Assign(int source, const GraphVector<int>& parent, const GraphVector<long long>& dist);
+
+    int Source() const;
+    int VertexCount() const;
+    int Parent(int v) const;
+    long long Dist(int v) const;
+    // 沿 parent 回溯，时间与路径长度成正比；不可达时返回空
+    std::vector<int> Path(int v) const;
+    size_t Bytes() const;
+
+private:
+    int source_ = 0;
+    PackedArray parent_;
+    // 可达顶点存 dist + 1，0 表示不可达
+    PackedArray dist_;
+};
+
+// 以起点为键的最短路径树缓存，按字节数严格限制容量，LRU 淘汰
+// 单棵树超过容量时不进入缓存，只放在一个临时槽中返回，不计入 Bytes
+// 图重新构建后（Generation 变化）自动清空
+class ShortestPathCache {
+public:
+    explicit ShortestPathCache(size_t capacityBytes);
+
+    // 命中直接返回，未命中则运行 Dijkstra 并放入缓存
+    // 返回的引用在下一次 Get 或 Clear 之前有效
+    const ShortestPathTree& Get(const GraphAdjList& graph, int source);
+    void Clear();
+
+    uint64_t Hits() const;
+    uint64_t Misses() const;
+    // 因超过容量而未缓存的次数
+    uint64_t Rejected() const;
+    size_t Bytes() const;
+    size_t CapacityBytes() const;
+    size_t EntryCount() const;
+
+private:
+    size_t capacityBytes_;
+    size_t bytes_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t rejected_ = 0;
+    uint64_t generation_ = 0;
+    // 表头为最近使用
+    std::list<ShortestPathTree> lru_;
+    std::unordered_map<int, std::list<ShortestPathTree>::iterator> index_;
+    // 超过容量的树放在这里返回给调用方
+    ShortestPathTree scratch_;
+
+    static size_t EntryBytes(const ShortestPathTree& tree);
+};
+
+#endif
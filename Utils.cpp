@@ -88,23 +88,7 @@ void PrintVisitOrder(const std::vector<int>& order) {
 }
 
 //计算最短路径时，根据终点重建路径
-std::vector<int> RebuildPath(const std::vector<int>& parent, int s, int v) {
-    std::vector<int> path;
-    if (v < 1 || v >= static_cast<int>(parent.size())) {
-        return path;
-    }
-    int cur = v;
-    while (cur != 0) {
-        path.push_back(cur);
-        if (cur == s) {
-            break;
-        }
-        cur = parent[cur];
-    }
-    if (path.back() != s) {
-        path.clear();
-        return path;
-    }
-    std::reverse(path.begin(), path.end());
-    return path;
+std::vector<int> RebuildPath(std::span<const int> parent, int s, int v) {
+    int vertexCount = parent.empty() ? 0 : static_cast<int>(parent.size()) - 1;
+    return WalkParentPath([parent](int x) { return parent[x]; }, vertexCount, s, v);
 }
@@ -1,7 +1,9 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <algorithm>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -20,6 +22,30 @@ bool ReadGraphFromFile(const std::string& path, int& n, int& m, std::vector<Edge
 void PrintEdgeList(const std::vector<std::pair<int, int>>& edges);
 void PrintVisitOrder(const std::vector<int>& order);
 
-std::vector<int> RebuildPath(const std::vector<int>& parent, int s, int v);
+// 从 v 沿 parentOf 回溯到 s，返回 s 到 v 的路径，不可达时返回空
+// parentOf(x) 给出 x 的父节点，0 表示没有父节点；顶点编号为 1..vertexCount
+template <typename ParentOf>
+std::vector<int> WalkParentPath(ParentOf parentOf, int vertexCount, int s, int v) {
+    std::vector<int> path;
+    if (v < 1 || v > vertexCount) {
+        return path;
+    }
+    int cur = v;
+    while (cur != 0) {
+        path.push_back(cur);
+        if (cur == s) {
+            break;
+        }
+        cur = parentOf(cur);
+    }
+    if (path.back() != s) {
+        path.clear();
+        return path;
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::vector<int> RebuildPath(std::span<const int> parent, int s, int v);
 
 #endif
@@ -1,5 +1,7 @@
-﻿#include "GraphAdjList.h"
+﻿#include "Benchmark.h"
+#include "GraphAdjList.h"
 #include "GraphAML.h"
+#include "ShortestPathCache.h"
 #include "Utils.h"
 
 #include <iostream>
@@ -14,37 +16,45 @@ static void ShowMenu() {
     std::cout << "4. BFS（AML）\n";
     std::cout << "5. 非递归 DFS（自定义栈）\n";
     std::cout << "6. 最短路径（Dijkstra）\n";
+    std::cout << "7. 建图性能测试（多线程）\n";
+    std::cout << "8. 桥、割点与点双连通分量\n";
+    std::cout << "9. 设置图内存分配策略（大页/NUMA）\n";
+    std::cout << "10. 遍历性能测试（大页/TLB）\n";
     std::cout << "0. 退出\n";
     std::cout << "请选择:";
 }
 
+//edges 是唯一的边存储，邻接表由它构建，AML 视图在首次使用时才建立
 static bool BuildGraph(GraphAdjList& adj, GraphAML& aml, int& n, std::vector<EdgeInput>& edges) {
-    adj.Init(n);
-    aml.Init(n);
-    for (const auto& e : edges) {
-        adj.AddEdge(e.u, e.v, e.w);
-        aml.AddEdge(e.u, e.v, e.w);
-    }
-    adj.SortAdjacency();
+    aml.Clear();
+    adj.Build(n, edges);
     return true;
 }
 
+static void EnsureAML(GraphAML& aml, int n, const std::vector<EdgeInput>& edges) {
+    if (!aml.IsReady()) {
+        aml.Build(n, edges);
+    }
+}
+
 int main() {
     GraphAdjList adj;
     GraphAML aml;
     int n = 0;
-    int m = 0;
     std::vector<EdgeInput> edges;
 
-    std::vector<int> bfsParent;
+    GraphVector<int> bfsParent;
     std::vector<std::pair<int, int>> bfsTreeEdges;
     std::vector<int> bfsOrder;
 
-    std::vector<int> dfsParent;
+    GraphVector<int> dfsParent;
     std::vector<std::pair<int, int>> dfsTreeEdges;
     std::vector<int> dfsOrder;
 
     const int defaultStart = 1;
+    //最短路径树缓存上限 64 MiB，同一起点重复查询时不再运行 Dijkstra
+    ShortestPathCache spCache(static_cast<size_t>(64) << 20);
+    LowLinkWorkspace lowLinkWorkspace;
 
     while (true) {
         ShowMenu();
@@ -57,20 +67,33 @@ int main() {
         }
 
         if (choice == 1) {
-            if (!ReadGraphInteractive(n, m, edges)) {
+            //读入失败时保留原图，成功后再替换共享边存储
+            int newN = 0;
+            int newM = 0;
+            std::vector<EdgeInput> newEdges;
+            if (!ReadGraphInteractive(newN, newM, newEdges)) {
                 continue;
             }
+            n = newN;
+            edges.swap(newEdges);
             BuildGraph(adj, aml, n, edges);
+            lowLinkWorkspace.Release();
             std::cout << "建图完成.\n";
         } else if (choice == 2) {
             std::cout << "请输入文件路径:";
             std::string path;
             std::cin >> path;
-            if (!ReadGraphFromFile(path, n, m, edges)) {
+            int newN = 0;
+            int newM = 0;
+            std::vector<EdgeInput> newEdges;
+            if (!ReadGraphFromFile(path, newN, newM, newEdges)) {
                 std::cout << "建图失败:文件格式错误\n";
                 continue;
             }
+            n = newN;
+            edges.swap(newEdges);
             BuildGraph(adj, aml, n, edges);
+            lowLinkWorkspace.Release();
             std::cout << "建图完成.\n";
         } else if (choice == 3) {
             if (!adj.IsReady()) {
@@ -81,10 +104,11 @@ int main() {
             adj.ExportGraphDot("graph.dot");
             std::cout << "已导出 graph.dot\n";
         } else if (choice == 4) {
-            if (!aml.IsReady()) {
+            if (!adj.IsReady()) {
                 std::cout << "请先建图.\n";
                 continue;
             }
+            EnsureAML(aml, n, edges);
             aml.BFS(defaultStart, bfsOrder, bfsTreeEdges, bfsParent);
             std::cout << "BFS 访问序列:";
             PrintVisitOrder(bfsOrder);
@@ -118,14 +142,12 @@ int main() {
                 std::cout << "起点不合法.\n";
                 continue;
             }
-            std::vector<int> parent;
-            std::vector<long long> dist;
-            adj.Dijkstra(s, parent, dist);
+            const ShortestPathTree& tree = spCache.Get(adj, s);
 
             std::cout << "最短距离与路径:\n";
             for (int v = 1; v <= adj.VertexCount(); ++v) {
-                std::cout << "s -> " << v << " 距离 = " << dist[v] << "，路径:";
-                std::vector<int> path = RebuildPath(parent, s, v);
+                std::cout << "s -> " << v << " 距离 = " << tree.Dist(v) << "，路径:";
+                std::vector<int> path = tree.Path(v);
                 for (size_t i = 0; i < path.size(); ++i) {
                     if (i > 0) {
                         std::cout << "->";
@@ -142,7 +164,7 @@ int main() {
                 std::cout << "终点不合法.\n";
                 continue;
             }
-            std::vector<int> path = RebuildPath(parent, s, t);
+            std::vector<int> path = tree.Path(t);
             std::cout << "s -> t 路径:";
             for (size_t i = 0; i < path.size(); ++i) {
                 if (i > 0) {
@@ -150,9 +172,64 @@ int main() {
                 }
                 std::cout << path[i];
             }
-            std::cout << "，总长度 = " << dist[t] << "\n";
-            adj.ExportShortestPathDot("shortest_path.dot", s, t, parent);
+            std::cout << "，总长度 = " << tree.Dist(t) << "\n";
+            adj.ExportPathDot("shortest_path.dot", path);
             std::cout << "已导出 shortest_path.dot\n";
+            std::cout << "最短路径树缓存: 命中 " << spCache.Hits() << "，未命中 " << spCache.Misses()
+                      << "，超出容量未缓存 " << spCache.Rejected() << "，占用 " << spCache.Bytes()
+                      << " / " << spCache.CapacityBytes() << " 字节\n";
+        } else if (choice == 7) {
+            std::cout << "请输入顶点数 n 与边数 m:";
+            int benchN = 0;
+            int benchM = 0;
+            if (!(std::cin >> benchN >> benchM)) {
+                return 0;
+            }
+            RunBuildBenchmark(benchN, benchM);
+        } else if (choice == 8) {
+            if (!adj.IsReady()) {
+                std::cout << "请先建图.\n";
+                continue;
+            }
+            LowLinkResult lowLink;
+            adj.LowLink(lowLink, lowLinkWorkspace);
+            std::cout << "桥:\n";
+            for (const auto& e : lowLink.bridges) {
+                std::cout << e.first << " -- " << e.second << "\n";
+            }
+            std::cout << "割点:";
+            PrintVisitOrder(lowLink.articulationPoints);
+            std::cout << "点双连通分量个数 = " << lowLink.bccOffsets.size() - 1 << "\n";
+            for (size_t k = 0; k + 1 < lowLink.bccOffsets.size(); ++k) {
+                std::cout << "分量 " << k + 1 << ":";
+                for (size_t i = lowLink.bccOffsets[k]; i < lowLink.bccOffsets[k + 1]; ++i) {
+                    std::cout << " (" << lowLink.bccEdges[i].first << "," << lowLink.bccEdges[i].second << ")";
+                }
+                std::cout << "\n";
+            }
+        } else if (choice == 9) {
+            std::cout << "当前策略: " << PagePolicyName(GetGraphPagePolicy()) << " / "
+                      << NumaPolicyName(GetGraphNumaPolicy()) << "\n";
+            std::cout << "页策略（0 默认页，1 透明大页，2 显式大页）与 NUMA 策略（0 默认，1 交错分配，2 首次访问）:";
+            int pages = 0;
+            int numa = 0;
+            if (!(std::cin >> pages >> numa)) {
+                return 0;
+            }
+            if (pages < 0 || pages > 2 || numa < 0 || numa > 2) {
+                std::cout << "策略不合法.\n";
+                continue;
+            }
+            SetGraphMemoryPolicy(static_cast<PagePolicy>(pages), static_cast<NumaPolicy>(numa));
+            std::cout << "已设置，之后建图与遍历分配的大数组生效.\n";
+        } else if (choice == 10) {
+            std::cout << "请输入顶点数 n 与边数 m:";
+            int benchN = 0;
+            int benchM = 0;
+            if (!(std::cin >> benchN >> benchM)) {
+                return 0;
+            }
+            RunTraversalBenchmark(benchN, benchM);
         } else {
             std::cout << "无效选项.\n";
         }